@@ -91,6 +91,24 @@ public:
     return out;
   }
 
+  /**
+   * \brief divide a whole block of durations at once
+   *
+   * The loop body is free of branches and cross iteration dependencies, so the fixed
+   * point multiply-shift paths auto-vectorize with SIMD instructions. Code which
+   * precomputes whole blocks of time differences (e.g. custom measurements, or
+   * BatchAccumulator below) should prefer this over per-duration divide calls.
+   *
+   * \param in  input array of durations, each must fulfill duration <= max_duration
+   * \param out output array of bin indices
+   * \param n   amount of elements
+   */
+  template <Mode mode> void divide_batch(const uint64_t *in, uint32_t *out, size_t n) const {
+    for (size_t i = 0; i < n; i++) {
+      out[i] = static_cast<uint32_t>(divide<mode>(in[i]));
+    }
+  }
+
   Mode getMode() const { return mode; }
 
 private:
@@ -153,6 +171,249 @@ private:
     break;                                                                                                             \
   }
 
+/**
+ * \brief Helper class for accumulating whole blocks of time differences into a histogram.
+ *
+ * It buffers precomputed time differences and flushes them through FastBinning in batches.
+ * This separates the bin index calculation from the histogram update, so the fixed point
+ * multiply-shift paths auto-vectorize with SIMD instructions instead of being interleaved
+ * with the per-tag stream logic. It is intended as a building block for custom correlation
+ * style measurements; the one-difference-at-a-time divide remains the scalar fallback for
+ * partial batches.
+ */
+class BatchAccumulator {
+public:
+  /// amount of buffered durations per flush, sized to keep the staging arrays within the L1 cache
+  static constexpr size_t batch_size = 1024;
+
+  BatchAccumulator() {}
+
+  /**
+   * \brief initialize the accumulator for a histogram
+   *
+   * \param binwidth width of one histogram bin in ps
+   * \param n_bins   number of bins in the histogram
+   */
+  BatchAccumulator(uint64_t binwidth, size_t n_bins) : binner(binwidth, binwidth * n_bins - 1) {
+    durations.reserve(batch_size);
+  }
+
+  /**
+   * \brief queue one time difference for accumulation
+   *
+   * The duration must be within the histogram range, so duration < binwidth * n_bins.
+   *
+   * \param duration  time difference in ps
+   * \param histogram histogram of size n_bins, flushed into when the batch is full
+   */
+  void accumulate(uint64_t duration, int32_t *histogram) {
+    durations.push_back(duration);
+    if (durations.size() == batch_size) {
+      flush(histogram);
+    }
+  }
+
+  /**
+   * \brief flush all queued time differences into the histogram
+   *
+   * \param histogram histogram of size n_bins
+   */
+  void flush(int32_t *histogram) {
+    BINNING_TEMPLATE_HELPER(flush_batch, binner, histogram);
+    durations.clear();
+  }
+
+private:
+  template <FastBinning::Mode mode> void flush_batch(int32_t *histogram) {
+    std::array<uint32_t, batch_size> bins;
+    const size_t n = durations.size();
+    binner.divide_batch<mode>(durations.data(), bins.data(), n);
+    for (size_t i = 0; i < n; i++) {
+      histogram[bins[i]]++;
+    }
+  }
+
+  FastBinning binner;
+  std::vector<uint64_t> durations;
+};
+
+/**
+ * \brief Helper class for matching coincidence groups via 64 bit channel masks.
+ *
+ * The channels seen inside a sliding coincidence window are folded into one 64 bit mask
+ * with one bit per configured channel. All configured groups are precomputed as masks
+ * and bucketed under one of their member channels, so a window is matched in
+ * O(groups hit) instead of O(groups): only the buckets of channels actually present in
+ * the window are scanned and each candidate costs one AND plus compare. It is intended
+ * as a building block for custom coincidence measurements with large channel counts and
+ * many overlapping groups, which process their tag blocks in batches of windows.
+ *
+ * Up to 64 distinct channels are supported, the constructor throws beyond that.
+ */
+class CoincidenceMaskTable {
+public:
+  CoincidenceMaskTable() {}
+
+  /**
+   * \brief precompute the mask tables for the given coincidence groups
+   *
+   * \param groups one vector of channels per coincidence group
+   */
+  CoincidenceMaskTable(const std::vector<std::vector<channel_t>> &groups) {
+    for (const std::vector<channel_t> &group : groups) {
+      uint64_t mask = 0;
+      for (channel_t channel : group) {
+        mask |= allocateBit(channel);
+      }
+      group_masks.push_back(mask);
+    }
+    // Bucket each group under its member channel with the least loaded bucket so far,
+    // so channels shared by many groups (e.g. a common trigger) do not degenerate the
+    // scan into O(groups).
+    for (size_t i = 0; i < group_masks.size(); i++) {
+      int best_bit = -1;
+      size_t best_load = ~size_t(0);
+      for (int bit = 0; bit < 64; bit++) {
+        if ((group_masks[i] >> bit) & 1 && buckets[bit].size() < best_load) {
+          best_load = buckets[bit].size();
+          best_bit = bit;
+        }
+      }
+      if (best_bit >= 0) {
+        buckets[best_bit].push_back(uint32_t(i));
+      }
+    }
+  }
+
+  /**
+   * \brief fetches the mask bit of one channel
+   *
+   * \param channel the channel to look up
+   * \return the mask with exactly the bit of this channel set, or 0 for unknown channels
+   */
+  uint64_t channelMask(channel_t channel) const {
+    for (size_t i = 0; i < channel_bits.size(); i++) {
+      if (channel_bits[i] == channel) {
+        return uint64_t(1) << i;
+      }
+    }
+    return 0;
+  }
+
+  /**
+   * \brief match all groups contained in the window mask
+   *
+   * Invokes the callback with the group index of every configured group whose channels
+   * are all present in window_mask. Only the buckets of present channels are scanned,
+   * so the cost is proportional to the groups hit plus the popcount of the mask.
+   */
+  template <typename Callback> void match(uint64_t window_mask, Callback &&callback) const {
+    uint64_t remaining = window_mask;
+    while (remaining) {
+      const int bit = countTrailingZeros(remaining);
+      remaining &= remaining - 1;
+      for (uint32_t index : buckets[bit]) {
+        if ((group_masks[index] & ~window_mask) == 0) {
+          callback(index);
+        }
+      }
+    }
+  }
+
+  /// amount of configured groups
+  size_t size() const { return group_masks.size(); }
+
+private:
+  uint64_t allocateBit(channel_t channel) {
+    const uint64_t known = channelMask(channel);
+    if (known) {
+      return known;
+    }
+    if (channel_bits.size() >= 64) {
+      throw std::invalid_argument("CoincidenceMaskTable: more than 64 distinct channels configured");
+    }
+    channel_bits.push_back(channel);
+    return uint64_t(1) << (channel_bits.size() - 1);
+  }
+
+  static int countTrailingZeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(value);
+#else
+    // Generic fallback
+    int bit = 0;
+    while (!(value & 1)) {
+      value >>= 1;
+      bit++;
+    }
+    return bit;
+#endif
+  }
+
+  std::vector<channel_t> channel_bits;
+  std::vector<uint64_t> group_masks;
+  std::array<std::vector<uint32_t>, 64> buckets;
+};
+
+/**
+ * \brief Helper class for expanding an event pattern over whole batches of triggers.
+ *
+ * Intended as a building block for custom measurements which, like the EventGenerator,
+ * emit a configured pattern once per trigger: generating those events one at a time
+ * competes with the real measurements for CPU at high trigger rates. This helper keeps
+ * the pattern as a template array and expands whole trigger batches at once: the output
+ * block is sized in one step and the inner loop is a plain vectorizable timestamp add,
+ * so the generation cost amortizes to a few instructions per emitted tag.
+ *
+ * The caller merges the expanded tags into the stream. With an ascending pattern and
+ * triggers spaced by at least the pattern span, the output is already sorted.
+ */
+class PatternExpander {
+public:
+  PatternExpander() {}
+
+  /**
+   * \brief initialize the expander
+   *
+   * \param pattern vector of time stamps generated relative to each trigger event
+   * \param channel the channel of the generated events
+   */
+  PatternExpander(std::vector<timestamp_t> pattern, channel_t channel)
+      : pattern(std::move(pattern)), channel(channel) {}
+
+  /// amount of events generated per trigger
+  size_t patternSize() const { return pattern.size(); }
+
+  /**
+   * \brief expand the pattern for a batch of trigger times
+   *
+   * Appends pattern.size() tags per trigger to the output block.
+   *
+   * \param triggers   sorted trigger timestamps
+   * \param n_triggers amount of triggers in the batch
+   * \param out        block the generated tags are appended to
+   */
+  void expand(const timestamp_t *triggers, size_t n_triggers, std::vector<Tag> &out) const {
+    const size_t pattern_len = pattern.size();
+    size_t index = out.size();
+    // one resize per batch, the fill value already carries the channel and the type
+    out.resize(index + n_triggers * pattern_len, Tag(0, channel));
+    Tag *tags = out.data();
+    for (size_t i = 0; i < n_triggers; i++) {
+      const timestamp_t base = triggers[i];
+      // only the timestamp store remains in the inner loop, so it vectorizes
+      for (size_t j = 0; j < pattern_len; j++) {
+        tags[index + j].time = base + pattern[j];
+      }
+      index += pattern_len;
+    }
+  }
+
+private:
+  std::vector<timestamp_t> pattern;
+  channel_t channel{};
+};
+
 /**
  * \defgroup ITERATOR All measurements and virtual channels
  *
@@ -958,6 +1219,27 @@ public:
   GET_DATA_1D(getMissedEvents, unsigned short, array_out, );
   GET_DATA_1D(getEventTypes, unsigned char, array_out, );
 
+#ifndef SWIG
+  /**
+   * \brief zero copy access to the internal arrays for C++ consumers
+   *
+   * Raw read-only pointers of length size into the internal arrays, avoiding the copy
+   * of the accessors above. The pointers stay valid until this buffer is modified or
+   * freed. The generated language bindings in this distribution do not use them and
+   * keep returning copies; exposing buffer protocol views there requires dedicated
+   * typemap work in the wrapper layer.
+   */
+  const channel_t *getChannelsData() const { return tagChannels.data(); }
+  /// \see getChannelsData
+  const timestamp_t *getTimestampsData() const { return tagTimestamps.data(); }
+  /// \see getChannelsData
+  const unsigned short *getMissedEventsData() const { return tagMissedEvents.data(); }
+  /// \see getChannelsData
+  const unsigned char *getEventTypesData() const {
+    return reinterpret_cast<const unsigned char *>(tagTypes.data());
+  }
+#endif
+
   uint64_t size;
   bool hasOverflows;
   timestamp_t tStart;
@@ -2173,6 +2455,121 @@ private:
   std::unique_ptr<CombinationsImpl> impl;
 };
 
+/**
+ * \ingroup HelperClasses
+ *
+ * \brief open addressing sparse histogram with timestamp keys
+ *
+ * Accumulation container for measurements which histogram sparse keys with an unknown
+ * range, e.g. unbounded start-stop times. Compared with a std::map based accumulation,
+ * the flat bucket storage avoids the per-node allocation and the pointer chasing on the
+ * hot path: one increment touches one cache line in the common case. The table keeps a
+ * load factor below 70 % and grows by rehashing into twice the bucket count. Entries are
+ * handed out sorted by key, so a getData implementation stays as simple as with the
+ * ordered map while the accumulation path is free of any ordering work.
+ */
+class SparseHistogram {
+public:
+  /// one key and its accumulated counts
+  struct Entry {
+    timestamp_t key;
+    size_t counts;
+  };
+
+  /**
+   * \brief construct a sparse histogram
+   *
+   * \param initial_buckets initial amount of buckets, rounded up to a power of two
+   */
+  SparseHistogram(size_t initial_buckets = 1024) { rehash(initial_buckets); }
+
+  /**
+   * \brief add counts for the given key
+   *
+   * \param key    the histogram position, e.g. a bin index
+   * \param counts amount to accumulate, defaults to 1
+   */
+  void accumulate(timestamp_t key, size_t counts = 1) {
+    if (counts == 0) {
+      return;
+    }
+    if (10 * filled >= 7 * buckets.size()) {
+      rehash(2 * buckets.size());
+    }
+    Entry &entry = findBucket(key);
+    if (entry.counts == 0) {
+      entry.key = key;
+      filled++;
+    }
+    entry.counts += counts;
+  }
+
+  /// amount of non-empty entries
+  size_t size() const { return filled; }
+
+  /// drop all entries, the bucket storage is kept
+  void clear() {
+    for (Entry &entry : buckets) {
+      entry.counts = 0;
+    }
+    filled = 0;
+  }
+
+  /**
+   * \brief fetches all entries sorted by key
+   *
+   * This is meant for the getData path of a measurement. The sort happens once per
+   * fetch instead of once per accumulated tag.
+   */
+  std::vector<Entry> getEntries() const {
+    std::vector<Entry> entries;
+    entries.reserve(filled);
+    for (const Entry &entry : buckets) {
+      if (entry.counts != 0) {
+        entries.push_back(entry);
+      }
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) { return a.key < b.key; });
+    return entries;
+  }
+
+private:
+  // Fibonacci hashing, the high bits of the product select the bucket
+  size_t hash(timestamp_t key) const { return size_t((uint64_t(key) * 0x9E3779B97F4A7C15ull) >> shift); }
+
+  // linear probing, empty buckets are marked by zero counts
+  Entry &findBucket(timestamp_t key) {
+    const size_t mask = buckets.size() - 1;
+    size_t index = hash(key);
+    while (buckets[index].counts != 0 && buckets[index].key != key) {
+      index = (index + 1) & mask;
+    }
+    return buckets[index];
+  }
+
+  void rehash(size_t n_buckets) {
+    size_t capacity = 16;
+    int new_shift = 60;
+    while (capacity < n_buckets) {
+      capacity *= 2;
+      new_shift--;
+    }
+    std::vector<Entry> old_buckets(capacity);
+    old_buckets.swap(buckets);
+    shift = new_shift;
+    filled = 0;
+    for (const Entry &entry : old_buckets) {
+      if (entry.counts != 0) {
+        accumulate(entry.key, entry.counts);
+      }
+    }
+  }
+
+  std::vector<Entry> buckets;
+  size_t filled{};
+  int shift{};
+};
+
 /**
  * \brief Helper class for custom measurements in Python and C#
  *
@@ -2717,6 +3114,116 @@ private:
   std::unique_ptr<SyntheticSingleTagImpl> impl;
 };
 
+/**
+ * \brief Helper class accumulating Allan type deviation statistics incrementally.
+ *
+ * Keeps per-tau streaming accumulators which are updated once per incoming phase
+ * sample, so fetching the deviation curves costs O(number of tau steps) regardless of
+ * the acquisition length. It is intended as a building block for custom clock analysis
+ * measurements which want to avoid recomputing the deviations from the stored trace on
+ * every poll: feed it from the processing path and scale the raw sums into the final
+ * STDD/ADEV/MDEV/HDEV curves on fetch.
+ *
+ * The memory requirement is dominated by the ring of the last 3 * max(steps) phase
+ * samples plus one window of second differences per tau.
+ */
+class StreamingDeviationAccumulator {
+public:
+  /// raw accumulation state of one tau step
+  struct TauSums {
+    double stdd_sum{};   ///< sum over squared first derivatives
+    double adev_sum{};   ///< sum over squared second derivatives
+    double mdev_sum{};   ///< sum over squared averaged second derivatives
+    double hdev_sum{};   ///< sum over squared third derivatives
+    uint64_t stdd_count{};
+    uint64_t adev_count{};
+    uint64_t mdev_count{};
+    uint64_t hdev_count{};
+  };
+
+  StreamingDeviationAccumulator() {}
+
+  /**
+   * \brief initialize the accumulators
+   *
+   * \param steps_ tau values in samples for all deviations
+   */
+  StreamingDeviationAccumulator(std::vector<uint64_t> steps_) : steps(std::move(steps_)) {
+    uint64_t max_step = 0;
+    for (uint64_t n : steps) {
+      assert(n > 0);
+      max_step = std::max(max_step, n);
+    }
+    ring.resize(3 * max_step + 1);
+    taus.resize(steps.size());
+    for (size_t i = 0; i < steps.size(); i++) {
+      taus[i].d2_window.resize(steps[i]);
+    }
+  }
+
+  /**
+   * \brief accumulate one phase sample
+   *
+   * \param phase the phase sample in seconds
+   */
+  void add(double phase) {
+    const uint64_t k = samples++;
+    ring[k % ring.size()] = phase;
+    for (size_t i = 0; i < steps.size(); i++) {
+      const uint64_t n = steps[i];
+      TauState &tau = taus[i];
+      if (k < n) {
+        continue;
+      }
+      const double x_1 = sample(k - n);
+      const double d1 = phase - x_1;
+      tau.sums.stdd_sum += d1 * d1;
+      tau.sums.stdd_count++;
+      if (k < 2 * n) {
+        continue;
+      }
+      const double d2 = phase - 2.0 * x_1 + sample(k - 2 * n);
+      tau.sums.adev_sum += d2 * d2;
+      tau.sums.adev_count++;
+      // rolling window of the last n second derivatives for the MDEV
+      tau.d2_window_sum += d2 - tau.d2_window[tau.d2_window_pos];
+      tau.d2_window[tau.d2_window_pos] = d2;
+      tau.d2_window_pos = (tau.d2_window_pos + 1 == n) ? 0 : tau.d2_window_pos + 1;
+      if (tau.sums.adev_count >= n) {
+        tau.sums.mdev_sum += tau.d2_window_sum * tau.d2_window_sum;
+        tau.sums.mdev_count++;
+      }
+      if (k < 3 * n) {
+        continue;
+      }
+      const double d3 = phase - 3.0 * x_1 + 3.0 * sample(k - 2 * n) - sample(k - 3 * n);
+      tau.sums.hdev_sum += d3 * d3;
+      tau.sums.hdev_count++;
+    }
+  }
+
+  /// amount of accumulated phase samples
+  uint64_t getSampleCount() const { return samples; }
+
+  /// fetches the raw sums of one tau step
+  const TauSums &getSums(size_t tau_index) const { return taus[tau_index].sums; }
+
+private:
+  double sample(uint64_t index) const { return ring[index % ring.size()]; }
+
+  struct TauState {
+    TauSums sums;
+    std::vector<double> d2_window;
+    double d2_window_sum{};
+    uint64_t d2_window_pos{};
+  };
+
+  std::vector<uint64_t> steps;
+  std::vector<double> ring;
+  std::vector<TauState> taus;
+  uint64_t samples{};
+};
+
 class FrequencyStabilityImpl;
 struct FrequencyStabilityDataImpl;
 class FrequencyStability;
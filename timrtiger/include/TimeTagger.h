@@ -1914,6 +1914,57 @@ private:
   std::list<OrderedBarrier>::iterator stage;
 };
 
+/**
+ * \brief Helper for recycling tag block allocations
+ *
+ * Tag blocks flow through the pipeline as std::vector<Tag>, and custom stages which
+ * rewrite or buffer the stream would reallocate a fresh vector per block. This pool is
+ * intended for such custom measurements: it hands out recycled fixed capacity slabs,
+ * the stage acquires a block, fills it and the last consumer releases it back, so
+ * steady state streaming performs no heap allocation and the worker threads do not
+ * contend on the allocator lock.
+ */
+class TagBlockPool {
+public:
+  /**
+   * \brief construct a pool of recycled tag blocks
+   *
+   * \param max_blocks amount of free blocks kept alive, blocks released beyond that are freed
+   */
+  TagBlockPool(size_t max_blocks = 64) : max_blocks(max_blocks) {}
+
+  /**
+   * \brief fetch an empty block, reusing the capacity of a recycled one when available
+   */
+  std::vector<Tag> acquire() {
+    std::lock_guard<std::mutex> lk(pool_mutex);
+    if (free_blocks.empty()) {
+      return std::vector<Tag>();
+    }
+    std::vector<Tag> block = std::move(free_blocks.back());
+    free_blocks.pop_back();
+    return block;
+  }
+
+  /**
+   * \brief return a block to the pool after the last consumer has finished with it
+   *
+   * The block is cleared, its capacity is kept alive for the next acquire call.
+   */
+  void release(std::vector<Tag> &&block) {
+    block.clear();
+    std::lock_guard<std::mutex> lk(pool_mutex);
+    if (free_blocks.size() < max_blocks) {
+      free_blocks.push_back(std::move(block));
+    }
+  }
+
+private:
+  const size_t max_blocks;
+  std::mutex pool_mutex;
+  std::vector<std::vector<Tag>> free_blocks;
+};
+
 /**
  * \brief Base class for all iterators
  */
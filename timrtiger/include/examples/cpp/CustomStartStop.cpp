@@ -36,12 +36,12 @@ void CustomStartStop::getData(std::function<timestamp_t *(size_t, size_t)> array
   auto lk = getLock();
 
   // return an interleaved output of {timestamp : clicks, ...}
-  // std::map is sorted, so just iterate over all elements
+  // getEntries hands out the accumulated bins sorted by key
   size_t size = data.size();
   timestamp_t *arr = array_out(size, 2);
-  for (auto &item : data) {
-    *arr++ = item.first * binwidth; // timestamp in ps
-    *arr++ = item.second;           // clicks
+  for (const SparseHistogram::Entry &item : data.getEntries()) {
+    *arr++ = item.key * binwidth; // timestamp in ps
+    *arr++ = item.counts;         // clicks
   }
 }
 
@@ -81,7 +81,7 @@ bool CustomStartStop::next_impl(std::vector<Tag> &incoming_tags, timestamp_t beg
       if (tag.channel == click_channel && last_start_tag != 0) {
         // On click tag: Increase the clicks in this bin by one.
         timestamp_t slot = (tag.time - last_start_tag) / binwidth;
-        data[slot]++;
+        data.accumulate(slot);
 
         // This shall be a single-stop measurement. If you like single-start multiple-stop, drop the next line.
         last_start_tag = 0;
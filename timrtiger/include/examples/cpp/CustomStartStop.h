@@ -3,9 +3,9 @@ This file is part of Time Tagger software defined digital data acquisition.
 */
 #pragma once
 
+#include "Iterators.h" // SparseHistogram
 #include "TimeTagger.h"
 
-#include <map>
 #include <vector>
 
 /**
@@ -71,5 +71,7 @@ private:
   timestamp_t last_start_tag;
 
   // data variable bin_index -> counts
-  std::map<timestamp_t, size_t> data;
+  // The flat sparse histogram keeps the hot path free of node allocations,
+  // see the SparseHistogram documentation in Iterators.h.
+  SparseHistogram data;
 };
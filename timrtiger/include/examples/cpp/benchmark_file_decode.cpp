@@ -0,0 +1,148 @@
+/*
+Decode speed benchmark for FileReader.
+
+Usage:
+  benchmark_file_decode [file.ttbin ...]
+
+With file arguments, the given dump files are used as the decode corpus.
+Without arguments and with hardware attached, synthetic files are generated
+first: the built-in test signal is recorded via FileWriter at several test
+signal divider settings, which varies the tag rate and thereby the timestamp
+delta entropy the compression has to work with. Recording through an overdriven
+low divider additionally produces overflow intervals, so the overflow decode
+path is covered as well.
+
+Each corpus is then decoded repeatedly over the native raw block path and a
+range of getData fetch sizes, reporting tags/s and MB/s of the fastest
+repetition. We run this on every software update to catch I/O path regressions
+before they reach the lab.
+*/
+
+#include <Iterators.h>  // FileReader, FileWriter
+#include <TimeTagger.h> // createTimeTagger, scanTimeTagger
+#include <algorithm>    // min
+#include <chrono>       // steady_clock, sleep durations
+#include <stdio.h>      // printf, fopen, remove
+#include <string>
+#include <thread> // sleep_for
+#include <vector>
+
+namespace {
+
+uint64_t file_size(const std::string &path) {
+  FILE *f = fopen(path.c_str(), "rb");
+  if (!f) {
+    return 0;
+  }
+  fseek(f, 0, SEEK_END);
+  long size = ftell(f);
+  fclose(f);
+  return size < 0 ? 0 : uint64_t(size);
+}
+
+/// one timed decode pass over the whole corpus, returns seconds
+double decode_pass(const std::vector<std::string> &files, uint64_t block_events, uint64_t &n_tags) {
+  FileReader reader(files);
+  n_tags = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  if (block_events == 0) {
+    // native block granularity of the file format
+    std::vector<Tag> buffer;
+    while (reader.getDataRaw(buffer)) {
+      n_tags += buffer.size();
+    }
+  } else {
+    // chunked fetches through the TimeTagStreamBuffer path
+    while (reader.hasData()) {
+      TimeTagStreamBuffer buffer = reader.getData(block_events);
+      n_tags += buffer.size;
+    }
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(t1 - t0).count();
+}
+
+void bench_files(const std::vector<std::string> &files) {
+  uint64_t total_bytes = 0;
+  for (const std::string &file : files) {
+    total_bytes += file_size(file);
+  }
+
+  const uint64_t block_sizes[] = {0, 1 << 16, 1 << 20}; // 0 = native raw blocks
+  const int repetitions = 3;
+
+  printf("decoding %llu MB of input:\n", (unsigned long long)(total_bytes >> 20));
+  printf("%10s %12s %10s\n", "block", "MTags/s", "MB/s");
+  for (uint64_t block : block_sizes) {
+    double best = 1e300;
+    uint64_t n_tags = 0;
+    for (int rep = 0; rep < repetitions; rep++) {
+      best = std::min(best, decode_pass(files, block, n_tags));
+    }
+    if (block == 0) {
+      printf("%10s", "native");
+    } else {
+      printf("%10llu", (unsigned long long)block);
+    }
+    printf(" %12.1f %10.1f\n", n_tags / best / 1e6, total_bytes / best / 1e6);
+  }
+}
+
+/// record the test signal at several rates into synthetic benchmark files
+std::vector<std::string> generate_files() {
+  std::vector<std::string> files;
+  if (scanTimeTagger().empty()) {
+    return files;
+  }
+  TimeTagger *tagger = createTimeTagger();
+  const std::vector<channel_t> channels{1, 2, 3, 4};
+  tagger->setTestSignal(channels, true);
+
+  // Low dividers raise the tag rate: smaller timestamp deltas compress
+  // differently, and the lowest setting overdrives the link on purpose to mix
+  // overflow intervals into the stream.
+  const int dividers[] = {63, 8, 1};
+  for (int divider : dividers) {
+    tagger->setTestSignalDivider(divider);
+    std::string filename = "benchmark_decode_div" + std::to_string(divider) + ".ttbin";
+    {
+      FileWriter writer(tagger, filename, channels);
+      std::this_thread::sleep_for(std::chrono::seconds(5));
+      writer.stop();
+    }
+    files.push_back(filename);
+    printf("generated %s (%llu MB)\n", filename.c_str(), (unsigned long long)(file_size(filename) >> 20));
+  }
+  freeTimeTagger(tagger);
+  return files;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::vector<std::string> files;
+  bool generated = false;
+  for (int i = 1; i < argc; i++) {
+    files.push_back(argv[i]);
+  }
+  if (files.empty()) {
+    files = generate_files();
+    generated = true;
+  }
+  if (files.empty()) {
+    printf("no input files given and no Time Tagger found to generate them\n");
+    printf("usage: benchmark_file_decode [file.ttbin ...]\n");
+    return -1;
+  }
+
+  bench_files(files);
+
+  if (generated) {
+    // the synthetic recordings are only benchmark artifacts
+    for (const std::string &file : files) {
+      remove(file.c_str());
+    }
+  }
+
+  return 0;
+}
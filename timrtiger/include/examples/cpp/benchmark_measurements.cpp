@@ -0,0 +1,148 @@
+/*
+Throughput benchmark for the major measurement classes.
+
+Deterministic blocks of time tags are synthesized and pushed directly into the
+next_impl handler of each measurement class, bypassing the backend pipeline.
+This measures how many MTags/s a single instance of each class sustains
+standalone, with warmup and statistical repetition, and is meant to detect
+performance regressions between software releases before they reach the
+acquisition setups.
+
+The synthesized workload approximates what the signal generator classes
+(UniformSignalGenerator and friends) produce in-stream: uncorrelated events
+with uniform pseudo random spacing on the channels 1..3. The generator is
+seeded with a constant, so every run processes the identical tag sequence.
+
+The harness overhead per block is one copy of the block plus one addition per
+tag for the monotonic time shift between repetitions. This corresponds to what
+a pipeline stage pays anyway and is identical for all benched measurements.
+*/
+
+#include <Iterators.h>  // measurement classes
+#include <TimeTagger.h> // struct Tag, createTimeTaggerVirtual
+#include <algorithm>    // min
+#include <chrono>       // steady_clock
+#include <stdio.h>      // printf, remove
+#include <vector>
+
+/// Expose the protected tag handler of a measurement for direct feeding.
+template <typename T> class Bench : public T {
+public:
+  using T::T;
+
+  /// Feed one block under the measurement mutex, like the backend worker does.
+  bool feed(std::vector<Tag> &tags, timestamp_t begin, timestamp_t end) {
+    auto lk = this->getLock();
+    return this->next_impl(tags, begin, end);
+  }
+};
+
+namespace {
+
+/// Deterministic pseudo random tag source on the channels 1..3.
+struct BlockSource {
+  uint32_t state = 0x2545F491u;
+
+  uint32_t next_random() {
+    state = state * 1664525u + 1013904223u; // LCG from Numerical Recipes
+    return state >> 8;
+  }
+
+  /// one block of n_tags sorted tags, all spacings are within [1, 2 * mean_spacing)
+  std::vector<Tag> make_block(size_t n_tags, timestamp_t begin, timestamp_t mean_spacing) {
+    std::vector<Tag> block;
+    block.reserve(n_tags);
+    timestamp_t t = begin;
+    for (size_t i = 0; i < n_tags; i++) {
+      t += 1 + next_random() % (2 * mean_spacing - 1);
+      block.emplace_back(t, channel_t(1 + next_random() % 3));
+    }
+    return block;
+  }
+};
+
+template <typename M>
+void run_bench(const char *name, Bench<M> &measurement, const std::vector<std::vector<Tag>> &blocks, timestamp_t span,
+               int warmup, int repetitions) {
+  uint64_t n_tags = 0;
+  for (const std::vector<Tag> &block : blocks) {
+    n_tags += block.size();
+  }
+
+  std::vector<Tag> scratch;
+  timestamp_t offset = 0;
+  double best = 1e300;
+
+  for (int rep = -warmup; rep < repetitions; rep++) {
+    auto t_start = std::chrono::steady_clock::now();
+
+    timestamp_t begin = offset;
+    for (const std::vector<Tag> &block : blocks) {
+      // copy with time shift, so every repetition sees a monotonic stream
+      scratch = block;
+      for (Tag &tag : scratch) {
+        tag.time += offset;
+      }
+      timestamp_t end = begin + span;
+      measurement.feed(scratch, begin, end);
+      begin = end;
+    }
+    offset = begin;
+
+    auto t_stop = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(t_stop - t_start).count();
+    if (rep >= 0) {
+      // report the fastest repetition, it has the least scheduling noise
+      best = std::min(best, seconds);
+    }
+  }
+
+  printf("%-14s %8.1f MTags/s  %7.2f ns/tag\n", name, n_tags / best / 1e6, best / n_tags * 1e9);
+}
+
+} // namespace
+
+int main() {
+  // deterministic workload: 16 blocks of 1M tags with ~30 ns mean spacing
+  const size_t n_blocks = 16;
+  const size_t block_tags = 1 << 20;
+  const timestamp_t mean_spacing = 30000; // ps, ~33 MTags/s equivalent
+  const timestamp_t span = block_tags * 2 * mean_spacing;
+
+  BlockSource source;
+  std::vector<std::vector<Tag>> blocks;
+  for (size_t i = 0; i < n_blocks; i++) {
+    blocks.push_back(source.make_block(block_tags, i * span, mean_spacing));
+  }
+
+  const int warmup = 1;
+  const int repetitions = 5;
+
+  // The virtual tagger provides the backend for the measurement constructors.
+  // No file is replayed on it, all data is fed directly within run_bench.
+  TimeTaggerVirtual *tagger = createTimeTaggerVirtual();
+  {
+    Bench<Counter> counter(tagger, std::vector<channel_t>{1, 2, 3}, 1000000000, 1000);
+    Bench<Countrate> countrate(tagger, std::vector<channel_t>{1, 2, 3});
+    Bench<Correlation> correlation(tagger, 2, 1, 100, 1000);
+    Bench<Histogram> histogram(tagger, 2, 1, 100, 1000);
+    Bench<Histogram2D> histogram2d(tagger, 1, 2, 3, 1000, 1000, 256, 256);
+    Bench<Coincidences> coincidences(tagger, {{1, 2}, {2, 3}, {1, 2, 3}}, 10000);
+    Bench<FileWriter> filewriter(tagger, "benchmark.ttbin", std::vector<channel_t>{1, 2, 3});
+
+    printf("benchmarking %zu MTags per repetition, best of %d:\n", n_blocks * block_tags / 1000000, repetitions);
+    run_bench("Counter", counter, blocks, span, warmup, repetitions);
+    run_bench("Countrate", countrate, blocks, span, warmup, repetitions);
+    run_bench("Correlation", correlation, blocks, span, warmup, repetitions);
+    run_bench("Histogram", histogram, blocks, span, warmup, repetitions);
+    run_bench("Histogram2D", histogram2d, blocks, span, warmup, repetitions);
+    run_bench("Coincidences", coincidences, blocks, span, warmup, repetitions);
+    run_bench("FileWriter", filewriter, blocks, span, warmup, repetitions);
+  }
+  freeTimeTagger(tagger);
+
+  // the FileWriter output is only a benchmark artifact
+  remove("benchmark.ttbin");
+
+  return 0;
+}
@@ -0,0 +1,102 @@
+/*
+Offline reprocessing of a dump file without the replay machinery.
+
+Usage:
+  offline_processing file.ttbin [more files ...]
+
+TimeTaggerVirtual::replay drags in the full realtime scheduling pipeline even
+when replaying as fast as possible. For pure batch reprocessing this harness
+feeds the decoded file blocks of a FileReader directly into the next_impl
+handler of regular measurement classes, under the measurement mutex like the
+backend worker would. There is no pacing, clock or USB plumbing in between, so
+the pass is limited only by decode and histogramming speed.
+
+As a demonstration, a Countrate and a Correlation between the channels 1 and 2
+are evaluated; adapt the measurement set and channels to the recording at hand.
+The same pattern works for every measurement class, see also the
+benchmark_measurements example.
+*/
+
+#include <Iterators.h>  // FileReader, measurement classes
+#include <TimeTagger.h> // struct Tag, createTimeTaggerVirtual
+#include <stdio.h>      // printf
+#include <string>
+#include <vector>
+
+/// Expose the protected tag handler of a measurement for direct feeding.
+template <typename T> class OfflineRunner : public T {
+public:
+  using T::T;
+
+  /// Feed one block under the measurement mutex, like the backend worker does.
+  bool feed(std::vector<Tag> &tags, timestamp_t begin, timestamp_t end) {
+    auto lk = this->getLock();
+    return this->next_impl(tags, begin, end);
+  }
+};
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    printf("usage: offline_processing file.ttbin [more files ...]\n");
+    return -1;
+  }
+  std::vector<std::string> files;
+  for (int i = 1; i < argc; i++) {
+    files.push_back(argv[i]);
+  }
+
+  // The virtual tagger only provides the backend for the measurement
+  // constructors, nothing is replayed on it.
+  TimeTaggerVirtual *tagger = createTimeTaggerVirtual();
+  {
+    OfflineRunner<Countrate> countrate(tagger, std::vector<channel_t>{1, 2});
+    OfflineRunner<Correlation> correlation(tagger, 2, 1, 100, 1000);
+
+    // stream all file blocks straight into the measurements
+    FileReader reader(files);
+    std::vector<Tag> block;
+    timestamp_t begin = 0;
+    bool first_block = true;
+    uint64_t n_tags = 0;
+    while (reader.getDataRaw(block)) {
+      if (block.empty()) {
+        continue;
+      }
+      // the block boundaries just have to enclose the contained tags
+      if (first_block) {
+        begin = block.front().time;
+        first_block = false;
+      }
+      timestamp_t end = block.back().time + 1;
+      countrate.feed(block, begin, end);
+      correlation.feed(block, begin, end);
+      begin = end;
+      n_tags += block.size();
+    }
+    printf("processed %llu tags\n", (unsigned long long)n_tags);
+
+    // fetch the results like after a live measurement
+    std::vector<double> rates;
+    countrate.getData([&rates](size_t n) {
+      rates.resize(n);
+      return rates.data();
+    });
+    for (size_t i = 0; i < rates.size(); i++) {
+      printf("channel %zu: %.1f counts/s\n", i + 1, rates[i]);
+    }
+
+    std::vector<int32_t> histogram;
+    correlation.getData([&histogram](size_t n) {
+      histogram.resize(n);
+      return histogram.data();
+    });
+    long long correlation_counts = 0;
+    for (int32_t bin : histogram) {
+      correlation_counts += bin;
+    }
+    printf("correlation histogram: %zu bins, %lld counts\n", histogram.size(), correlation_counts);
+  }
+  freeTimeTagger(tagger);
+
+  return 0;
+}